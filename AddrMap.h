@@ -0,0 +1,189 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * AddrMap.h - Definition of a compact map from addresses to
+ * object pointers.
+ ***************************************************************/
+
+#ifndef __ADDRMAP_H__
+#define __ADDRMAP_H__
+
+#include <vector>
+#include <algorithm>
+
+/* Open addressing hash of address to a non-NULL pointer. Find never modifies the map,
+ * iteration is in ascending address order like the std::map it replaces. */
+template<typename T> class CAddrMap
+{
+public:
+	struct Slot
+	{
+		unsigned int first;
+		/* NULL for an empty slot */
+		T second;
+	};
+
+private:
+	std::vector<Slot> m_slots;
+	unsigned int m_iCount;
+	/* Shift to take the top bits of the hash as the slot index */
+	unsigned int m_iShift;
+	/* Slot indexes sorted by address, only valid when m_blSorted is set */
+	std::vector<unsigned int> m_order;
+	bool m_blSorted;
+
+	struct CompareSlot
+	{
+		const std::vector<Slot> &slots;
+		CompareSlot(const std::vector<Slot> &s) : slots(s) {}
+		bool operator()(unsigned int left, unsigned int right) const
+		{
+			return slots[left].first < slots[right].first;
+		}
+	};
+
+	unsigned int FindSlot(unsigned int addr) const
+	{
+		unsigned int mask = m_slots.size() - 1;
+		unsigned int pos = (unsigned int) (addr * 0x9E3779B1U) >> m_iShift;
+
+		while((m_slots[pos].second != NULL) && (m_slots[pos].first != addr))
+		{
+			pos = (pos + 1) & mask;
+		}
+
+		return pos;
+	}
+
+	void Grow()
+	{
+		std::vector<Slot> old;
+		Slot empty;
+		unsigned int i;
+
+		empty.first = 0;
+		empty.second = NULL;
+		old.swap(m_slots);
+		m_slots.assign(old.size() ? (old.size() * 2) : 64, empty);
+		m_iShift = 32;
+		for(i = m_slots.size(); i > 1; i >>= 1)
+		{
+			m_iShift--;
+		}
+		for(i = 0; i < old.size(); i++)
+		{
+			if(old[i].second != NULL)
+			{
+				m_slots[FindSlot(old[i].first)] = old[i];
+			}
+		}
+	}
+
+	void Sort()
+	{
+		unsigned int i;
+
+		m_order.clear();
+		m_order.reserve(m_iCount);
+		for(i = 0; i < m_slots.size(); i++)
+		{
+			if(m_slots[i].second != NULL)
+			{
+				m_order.push_back(i);
+			}
+		}
+		std::sort(m_order.begin(), m_order.end(), CompareSlot(m_slots));
+		m_blSorted = true;
+	}
+
+public:
+	class iterator
+	{
+		const CAddrMap *m_pMap;
+		unsigned int m_iPos;
+	public:
+		iterator(const CAddrMap *pMap, unsigned int iPos) : m_pMap(pMap), m_iPos(iPos) {}
+		const Slot &operator*() const { return m_pMap->m_slots[m_pMap->m_order[m_iPos]]; }
+		const Slot *operator->() const { return &m_pMap->m_slots[m_pMap->m_order[m_iPos]]; }
+		iterator &operator++() { m_iPos++; return *this; }
+		iterator operator++(int) { iterator it = *this; m_iPos++; return it; }
+		bool operator==(const iterator &it) const { return m_iPos == it.m_iPos; }
+		bool operator!=(const iterator &it) const { return m_iPos != it.m_iPos; }
+	};
+
+	CAddrMap() : m_iCount(0), m_iShift(32), m_blSorted(false) {}
+
+	/* Get the pointer stored for an address, NULL if there is none */
+	T Find(unsigned int addr) const
+	{
+		if(m_iCount == 0)
+		{
+			return NULL;
+		}
+
+		return m_slots[FindSlot(addr)].second;
+	}
+
+	/* Store a pointer for an address, replacing any existing one */
+	void Set(unsigned int addr, T value)
+	{
+		unsigned int pos;
+
+		if(value == NULL)
+		{
+			return;
+		}
+
+		/* Keep the load factor at or below a half */
+		if(((m_iCount + 1) * 2) > m_slots.size())
+		{
+			Grow();
+		}
+
+		pos = FindSlot(addr);
+		if(m_slots[pos].second == NULL)
+		{
+			m_slots[pos].first = addr;
+			m_iCount++;
+			m_blSorted = false;
+		}
+		m_slots[pos].second = value;
+	}
+
+	void clear()
+	{
+		m_slots.clear();
+		m_order.clear();
+		m_iCount = 0;
+		m_blSorted = false;
+	}
+
+	unsigned int size() const
+	{
+		return m_iCount;
+	}
+
+	/* Iterators are invalidated by adding a new address */
+	iterator begin()
+	{
+		if(m_blSorted == false)
+		{
+			Sort();
+		}
+
+		return iterator(this, 0);
+	}
+
+	iterator end()
+	{
+		if(m_blSorted == false)
+		{
+			Sort();
+		}
+
+		return iterator(this, m_order.size());
+	}
+};
+
+#endif
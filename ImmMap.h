@@ -0,0 +1,125 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * ImmMap.h - Definition of a flat table of the immediates found
+ * by the relocations.
+ ***************************************************************/
+
+#ifndef __IMMMAP_H__
+#define __IMMMAP_H__
+
+#include <vector>
+#include <algorithm>
+
+struct ImmEntry
+{
+	unsigned int addr;
+	unsigned int target;
+	/* Does this entry point to a text section ? */
+	int text;
+};
+
+/* Immediates held by value in one array. They are added while fixing up the relocations,
+ * then Sort puts them in address order and they can be looked up. */
+class CImmMap
+{
+	std::vector<ImmEntry> m_imms;
+	bool m_blSorted;
+
+	struct CompareImm
+	{
+		bool operator()(const ImmEntry &left, const ImmEntry &right) const
+		{
+			return left.addr < right.addr;
+		}
+		bool operator()(const ImmEntry &left, unsigned int addr) const
+		{
+			return left.addr < addr;
+		}
+	};
+
+public:
+	CImmMap() : m_blSorted(true) {}
+
+	/* Make room for iCount entries so adding them doesn't reallocate */
+	void Reserve(unsigned int iCount)
+	{
+		m_imms.reserve(iCount);
+	}
+
+	/* Add an entry, if there is already one for the address the last added is kept */
+	void Add(unsigned int addr, unsigned int target, int text)
+	{
+		ImmEntry imm;
+
+		imm.addr = addr;
+		imm.target = target;
+		imm.text = text;
+		m_imms.push_back(imm);
+		m_blSorted = false;
+	}
+
+	/* Sort the entries by address and drop the replaced ones, must be called before lookups */
+	void Sort()
+	{
+		unsigned int iIn;
+		unsigned int iOut = 0;
+
+		if(m_blSorted)
+		{
+			return;
+		}
+
+		std::stable_sort(m_imms.begin(), m_imms.end(), CompareImm());
+		for(iIn = 0; iIn < m_imms.size(); iIn++)
+		{
+			if(((iIn + 1) < m_imms.size()) && (m_imms[iIn + 1].addr == m_imms[iIn].addr))
+			{
+				continue;
+			}
+			m_imms[iOut++] = m_imms[iIn];
+		}
+		m_imms.resize(iOut);
+		m_blSorted = true;
+	}
+
+	/* Index of the first entry at or above addr, size() if there is none */
+	unsigned int LowerBound(unsigned int addr) const
+	{
+		return std::lower_bound(m_imms.begin(), m_imms.end(), addr, CompareImm()) - m_imms.begin();
+	}
+
+	/* Get the entry for an address, NULL if there is none */
+	const ImmEntry *Find(unsigned int addr) const
+	{
+		unsigned int iPos = LowerBound(addr);
+
+		if((iPos < m_imms.size()) && (m_imms[iPos].addr == addr))
+		{
+			return &m_imms[iPos];
+		}
+
+		return NULL;
+	}
+
+	const ImmEntry &operator[](unsigned int iPos) const
+	{
+		return m_imms[iPos];
+	}
+
+	unsigned int size() const
+	{
+		return m_imms.size();
+	}
+
+	void clear()
+	{
+		std::vector<ImmEntry>().swap(m_imms);
+		m_blSorted = true;
+	}
+};
+
+typedef CImmMap ImmMap;
+
+#endif
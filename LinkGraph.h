@@ -0,0 +1,90 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * LinkGraph.h - Definition of a class to resolve the imports
+ * of a set of modules against each other's exports.
+ ***************************************************************/
+
+#ifndef __LINKGRAPH_H__
+#define __LINKGRAPH_H__
+
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "types.h"
+#include "prxtypes.h"
+#include "OutputSink.h"
+
+/** A function or variable of an imported or exported library */
+struct LinkEntry
+{
+	u32 nid;
+	std::string name;
+	/** Address of the export, or the stub of the import */
+	u32 addr;
+};
+
+struct LinkLib
+{
+	std::string name;
+	u32 flags;
+	/** File the NID XML says exports the library, for imports */
+	std::string file;
+	std::vector<LinkEntry> funcs;
+	std::vector<LinkEntry> vars;
+};
+
+struct LinkModule
+{
+	std::string name;
+	std::string file;
+	std::vector<LinkLib> exports;
+	std::vector<LinkLib> imports;
+};
+
+/** An exported NID in the global index */
+struct LinkTarget
+{
+	u32 nid;
+	/** Index of the exporting module and its export entry */
+	int iModule;
+	const LinkEntry *pEntry;
+};
+
+/** Counts of the resolved imports */
+struct LinkCounts
+{
+	int iResolved;
+	int iMissing;
+	int iUnknownLib;
+	int iAmbiguous;
+};
+
+class CLinkGraph
+{
+	typedef std::map<std::string, std::vector<LinkTarget> > LinkIndex;
+
+	std::vector<LinkModule> m_modules;
+	/** Exported NIDs of each library sorted by NID, the first module to export a NID comes first */
+	LinkIndex m_index;
+	LinkCounts m_counts;
+
+	static void CopyEntries(std::vector<LinkEntry> &entries, const PspEntry *pEntries, int iCount);
+	void BuildIndex();
+	void AddIndex(const std::string &lib, const std::vector<LinkEntry> &entries, int iModule);
+	const LinkTarget *Find(const std::vector<LinkTarget> &targets, u32 nid, bool &blAmbiguous) const;
+	void WriteEntries(COutputSink &out, const char *szType, const std::vector<LinkEntry> &entries,
+			const std::vector<LinkTarget> *pTargets);
+public:
+	CLinkGraph();
+	~CLinkGraph();
+	/** Copy the imports and exports of a loaded module */
+	void AddModule(const char *szFilename, const PspModule *pMod);
+	/** Resolve every import and write the graph as text */
+	bool Write(FILE *fp);
+	const LinkCounts &GetCounts() const { return m_counts; }
+};
+
+#endif
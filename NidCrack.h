@@ -0,0 +1,91 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * NidCrack.h - Definition of a class to find the names of
+ * unknown NIDs from a word list.
+ ***************************************************************/
+
+#ifndef __NIDCRACK_H__
+#define __NIDCRACK_H__
+
+#include <stdio.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "types.h"
+#include "prxtypes.h"
+
+/* Number of candidate names hashed together */
+#define CRACK_LANES 8
+/* Number of words given to each work item */
+#define CRACK_WORDS_PER_ITEM 64
+
+/** A library with NIDs that have no known name */
+struct CrackLib
+{
+	/** The file and name of the module exporting the library, if known */
+	std::string prx;
+	std::string prx_name;
+	u32 flags;
+	/** Set when the library came from an export rather than an import */
+	bool blExport;
+	std::set<u32> funcs;
+	std::set<u32> vars;
+};
+
+/** A candidate name which hashed to a wanted NID */
+struct CrackMatch
+{
+	u32 nid;
+	std::string name;
+};
+
+/** Searches prefix + word + suffix candidates for names which hash to unknown NIDs */
+class CNidCrack
+{
+	typedef std::map<std::string, CrackLib> CrackLibMap;
+	typedef void (*HashFunc)(const u32 *pBlocks, u32 *pNids);
+
+	/** Libraries with unknown NIDs keyed on library name */
+	CrackLibMap m_libs;
+	/** The NIDs being searched for, sorted */
+	std::vector<u32> m_nids;
+	/** Bit for each value of the low 16 bits of the wanted NIDs */
+	std::vector<u32> m_filter;
+	std::vector<std::string> m_words;
+	std::vector<std::string> m_prefixes;
+	std::vector<std::string> m_suffixes;
+	/** Names found for each NID in the order they were found */
+	std::map<u32, std::vector<std::string> > m_found;
+	/** Matches of each work item of a run, merged in order */
+	std::vector<std::vector<CrackMatch> > m_results;
+	HashFunc m_fnHash;
+	unsigned long long m_iTried;
+
+	static bool LoadList(const char *szFilename, std::vector<std::string> &list, bool blAffix);
+	static void CrackWork(int iIndex, void *pArg);
+	static void CrackDone(int iIndex, void *pArg);
+	bool IsWanted(u32 nid) const;
+	void CrackWords(unsigned int iFirst, unsigned int iCount, std::vector<CrackMatch> &matches);
+	void AddLibrary(const char *lib, const char *prx, const char *prx_name, u32 flags, bool blExport,
+			const PspEntry *funcs, int f_count, const PspEntry *vars, int v_count);
+public:
+	CNidCrack();
+	~CNidCrack();
+	/** Collect the NIDs of a loaded module which only have a generated name */
+	void AddModule(const char *szFilename, const PspModule *pMod);
+	bool LoadWords(const char *szFilename);
+	/** Load prefixes or suffixes, one per line, a blank line is the empty string */
+	bool LoadPrefixes(const char *szFilename);
+	bool LoadSuffixes(const char *szFilename);
+	/** Try every candidate on up to iThreads threads, 0 uses every CPU */
+	void Run(int iThreads);
+	/** Write the libraries with the names found as a NID XML file */
+	bool WriteXml(FILE *fp);
+	/** Get the NID of a name, as the first 32 bits of its SHA-1 read little endian */
+	static u32 NameToNid(const char *name, unsigned int iLen);
+};
+
+#endif
@@ -10,8 +10,11 @@
 #define __NIDMGR_H__
 
 #include "types.h"
+#include "nidtypes.h"
+#include <stdio.h>
 #include <tinyxml/tinyxml.h>
 #include <vector>
+#include "StringPool.h"
 
 #define LIB_NAME_MAX 64
 #define LIB_SYMBOL_NAME_MAX 128
@@ -33,12 +36,12 @@ struct LibraryNid
 	struct LibraryEntry *pParentLib;
 };
 
-/** Structure to hold a single function entry */
+/** Structure to hold a single function entry, the strings belong to the CNidMgr */
 struct FunctionType
 {
-	char name[FUNCTION_NAME_MAX];
-	char args[FUNCTION_ARGS_MAX];
-	char ret[FUNCTION_RET_MAX];
+	const char *name;
+	const char *args;
+	const char *ret;
 };
 
 /** Structure to hold a single library entry */
@@ -64,21 +67,91 @@ struct LibraryEntry
 	LibraryNid *pNids;
 };
 
+/** Slot of a NID hash table */
+struct NidHashEntry
+{
+	/** Hash of the library name and NID */
+	u32 hash;
+	/** The NID value */
+	u32 nid;
+	/** The library name, NULL in the master NID table */
+	const char *lib;
+	/** The symbol name, NULL for an empty slot */
+	const char *name;
+};
+
+/** A binary NID database loaded into memory, see nidtypes.h */
+struct NidDatabase
+{
+	u8 *pData;
+	u32 iSize;
+	/** Indicates pData is a file mapping rather than allocated */
+	bool blMapped;
+	const char *pStrings;
+	u32 iStringSize;
+	const NidDbLib *pLibs;
+	u32 iLibCount;
+	const NidDbNid *pNids;
+	u32 iNidCount;
+	const NidDbHashEntry *pLibIndex;
+	u32 iLibIndexSize;
+	/** Master NID table index, NULL if there is no master table */
+	const NidDbHashEntry *pMasterIndex;
+	u32 iMasterIndexSize;
+	u32 iMaster;
+};
+
 /** Class to load and manage a list of libraries */
 class CNidMgr
 {
-	typedef std::vector<FunctionType *> FunctionVect;
+	typedef std::vector<FunctionType> FunctionVect;
+	typedef std::vector<NidHashEntry> NidHashTable;
 
 	/** Head pointer to the list of libraries */
 	LibraryEntry *m_pLibHead;
-	/** Mapping of function names to prototypes */
+	/** Function prototypes in the order they were loaded */
 	FunctionVect  m_funcMap;
-	/** A buffer to store a pre-generated symbol name so it can be passed to the caller */
-	char m_szCurrName[LIB_SYMBOL_NAME_MAX];
+	/** Open addressing hash of indexes into m_funcMap keyed on name, -1 for an empty slot */
+	std::vector<int> m_funcIndex;
+	/** Storage for the prototype strings */
+	CStringPool m_funcStrings;
+	/** A buffer to store a pre-generated symbol name so it can be passed to the caller,
+	 * one per thread so several PRXes can be loaded at once */
+	static thread_local char m_szCurrName[LIB_SYMBOL_NAME_MAX];
 	/** Indicator that we have loaded a master NID file */
 	LibraryEntry *m_pMasterNids;
+	/** Index of the library NIDs keyed on library name and NID */
+	NidHashTable m_libIndex;
+	/** Index of the master NID table keyed on NID */
+	NidHashTable m_masterIndex;
+	static u32 HashNid(const char *lib, u32 nid);
+	static void InsertNid(NidHashTable &table, const char *lib, const LibraryNid *pNid);
+	static const char *LookupNid(const NidHashTable &table, const char *lib, u32 nid);
+	/** Rebuild the NID indexes from the library list */
+	void BuildIndex();
+	/** The binary database in use, pData is NULL if none is loaded */
+	NidDatabase m_db;
+	const char *DbString(u32 iOfs);
+	const char *LookupDbNid(const NidDbHashEntry *pTable, u32 iSize, const char *lib, u32 nid);
+	bool MapDatabase(const char *szFilename);
+	void FreeDatabase();
+	/** Convert the binary database into the library list so it can be merged with others */
+	void ExpandDatabase();
+	bool WriteDatabaseData(FILE *fp, int &iLibCount, int &iNidCount);
+	/** Directory to cache compiled XML and function files in, NULL if not caching */
+	static const char *m_szCacheDir;
+	/** Move the libraries of another manager to the head of our list */
+	void TakeLibraries(CNidMgr &other);
+	bool LoadXmlFile(const char *szFilename);
+	void AddFunction(const char *name, const char *args, const char *ret);
+	/** Rebuild the prototype index from m_funcMap */
+	void BuildFunctionIndex();
+	bool LoadFunctionFile(const char *szFilename);
+	bool LoadCachedFunctions(const char *szPath);
+	bool WriteCachedFunctions(const char *szPath, unsigned int iFirst);
 	/** Generate a name */
 	const char *GenName(const char *lib, u32 nid);
+	static void FormatGenName(char *szName, const char *lib, u32 nid);
 	/** Search the loaded libs for a symbol */
 	const char *SearchLibs(const char *lib, u32 nid);
 	void FreeMemory();
@@ -90,11 +163,23 @@ public:
 	CNidMgr();
 	~CNidMgr();
 	const char *FindLibName(const char *lib, u32 nid);
+	/** Returns true if name is a generated name just returned by FindLibName on this thread */
+	static bool IsGenName(const char *name) { return name == m_szCurrName; }
+	/** Returns true if name is the name generated for a NID of lib which has no name */
+	static bool IsGenName(const char *lib, const char *name, u32 nid);
 	const char *FindDependancy(const char *lib);
 	bool AddXmlFile(const char *szFilename);
+	bool AddDatabaseFile(const char *szFilename);
+	/** Add either an XML or a binary NID database file */
+	bool AddNidFile(const char *szFilename);
+	/** Write the loaded libraries out as a binary NID database */
+	bool WriteDatabase(FILE *fp);
 	LibraryEntry *GetLibraries(void);
 	bool AddFunctionFile(const char *szFilename);
-	FunctionType *FindFunctionType(const char *name);
+	/** Find the prototype for a function name, the result is valid until another file is added */
+	const FunctionType *FindFunctionType(const char *name);
+	/** Set the directory used to cache compiled XML and function files, NULL disables it */
+	static void SetCacheDir(const char *szDir);
 };
 
 #endif
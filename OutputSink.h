@@ -0,0 +1,74 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * OutputSink.h - Definition of a class to buffer large amounts
+ * of text output.
+ ***************************************************************/
+
+#ifndef __OUTPUTSINK_H__
+#define __OUTPUTSINK_H__
+
+#include <stdio.h>
+#include <stddef.h>
+
+/* Size of the buffer of a sink writing to a file */
+#define SINK_BUFFER_SIZE (256*1024)
+
+/** Collects text in a large buffer and writes it to a file with a single write per buffer,
+ * or keeps it all in memory when there is no file */
+class COutputSink
+{
+	FILE *m_fp;
+	char *m_pBuffer;
+	size_t m_iSize;
+	size_t m_iUsed;
+	/* Bytes passed to the file so far */
+	unsigned long long m_iWritten;
+	bool m_blError;
+
+	/* Sinks own their buffer so can't be copied */
+	COutputSink(const COutputSink &);
+	COutputSink &operator=(const COutputSink &);
+
+	/** Make room for at least iSize more bytes */
+	void Reserve(size_t iSize);
+	/** Write out the buffer, or grow it if there is no file */
+	void Drain(size_t iNeeded);
+public:
+	/** Create a sink which collects its output in memory */
+	COutputSink();
+	/** Create a sink which writes to fp, anything already buffered in fp is written first */
+	COutputSink(FILE *fp);
+	~COutputSink();
+
+	void Write(const char *pData, size_t iSize);
+	void Puts(const char *str);
+	void Putc(char ch)
+	{
+		if(m_iUsed == m_iSize)
+		{
+			Drain(1);
+		}
+		m_pBuffer[m_iUsed++] = ch;
+	}
+	/** Output str left aligned and padded with spaces to iWidth, like %-Ns */
+	void PutPadded(const char *str, int iWidth);
+	/** Output val as 0x followed by iDigits upper case hex digits, like 0x%08X */
+	void PutHex(unsigned int val, int iDigits);
+	/** Output val in decimal, like %d */
+	void PutDec(int val);
+	void Printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+	/** Write out any buffered text, does nothing for a memory sink */
+	void Flush();
+
+	/** Get the text collected by a memory sink */
+	const char *GetData() const { return m_pBuffer; }
+	size_t GetSize() const { return m_iUsed; }
+	/** Get the number of bytes output so far, written or still buffered */
+	unsigned long long GetTotal() const { return m_iWritten + m_iUsed; }
+	/** Returns true if writing to the file failed */
+	bool HasError() const { return m_blError; }
+};
+
+#endif
@@ -10,6 +10,7 @@
 
 #include "types.h"
 #include "elftypes.h"
+#include "Stats.h"
 
 class CProcessElf
 {
@@ -20,6 +21,15 @@ protected:
 	u8 *m_pElfBin;
 	u32 m_iBinSize;
 	bool m_blElfLoaded;
+	/* Indicates m_pElf is a read only file mapping rather than a heap copy */
+	bool m_blElfMapped;
+	/* Mapping backing the binary image (m_pElfBin may point part way into it) */
+	u8 *m_pBinMap;
+	u32 m_iBinMapSize;
+	/* File descriptor of the mapped elf, only held open while the image is built */
+	int m_iElfFd;
+	/* Whether files should be memory mapped or read into memory */
+	static bool m_blMapFiles;
 
 	char m_szFilename[MAXPATH];
 
@@ -42,15 +52,20 @@ protected:
 
 	/* The base address of the ELF */
 	u32 m_iBaseAddr;
+	/* Where to record the timings and counters of loading, NULL if not wanted */
+	FileStats *m_pStats;
 
 	const char *GetSymbolName(u32 name, u32 shndx);
 
 	void ElfLoadHeader(const Elf32_Ehdr* pHeader);
 	bool ElfValidateHeader();
 	void ElfDumpHeader();
+	bool AllocBinaryImage(u32 iSize, u32 iFileOfs);
+	bool CopyToBinaryImage(u32 iBinOfs, u32 iFileOfs, u32 iSize);
 	bool BuildBinaryImage();
 	bool BuildFakeSections(unsigned int dwDataBase);
-	u8* LoadFileToMem(const char *szFilename, u32 &lSize);
+	u8* MapFileToMem(const char *szFilename, u32 &lSize, bool blWritable);
+	u8* LoadFileToMem(const char *szFilename, u32 &lSize, bool blWritable, bool &blMapped);
 	bool LoadPrograms();
 	bool FillSection(ElfSection& elfSect, const Elf32_Shdr *pSection);
 	void ElfDumpSections();
@@ -82,6 +97,10 @@ public:
 	ElfSection* ElfGetSections(u32 &iSHCount);
 	/** Get the file name of the loaded elf */
 	const char* GetElfName();
+	/** Enable or disable memory mapped loading of files (on by default) */
+	static void SetMapFiles(bool blMapFiles);
+	/** Record the timings and counters of loading and output in pStats, NULL to stop */
+	void SetStats(FileStats *pStats);
 };
 
 #endif
@@ -13,11 +13,25 @@
 #include "prxtypes.h"
 #include "NidMgr.h"
 #include "disasm.h"
+#include "ImmMap.h"
+#include "StringPool.h"
+#include "OutputSink.h"
+
+/* The instructions of a code section, decoded once when the maps are built */
+struct DecodedSection
+{
+	/* Address of the section including the base, and its data in the virtual memory */
+	u32 dwAddr;
+	const u8 *pData;
+	std::vector<DecodedInsn> insns;
+};
 
 /* Define ProcessPrx derived from ProcessElf */
 class CProcessPrx : public CProcessElf
 {
 	PspModule m_modInfo;
+	/* Names of the module's imports and exports */
+	CStringPool m_strings;
 	CNidMgr   m_defNidMgr;
 	CNidMgr*  m_pCurrNidMgr;
 	CVirtualMem m_vMem;
@@ -28,6 +42,10 @@ class CProcessPrx : public CProcessElf
 	int m_iRelocCount;
 	ImmMap m_imms;
 	SymbolMap m_syms;
+	std::vector<DecodedSection> m_decoded;
+	DisasmContext m_disCtx;
+	/* Number of threads used to disassemble a section */
+	int m_iThreads;
 	u32 m_dwBase;
 	u32 m_stubBottom;
 	bool m_blXmlDump;
@@ -39,21 +57,29 @@ class CProcessPrx : public CProcessElf
 	bool LoadImports();
 	int  LoadSingleExport(PspModuleExport *pExport, u32 addr);
 	bool LoadExports();
-	int  CountRelocs();
+	int  CountRelocsTypeA();
 	int  LoadRelocsTypeA(struct ElfReloc *pRelocs);
-	int  LoadRelocsTypeB(struct ElfReloc *pRelocs);
+	bool CheckRelocsTypeB();
+	bool LoadRelocsTypeB(std::vector<ElfReloc> &relocs);
 	bool LoadRelocs();
 	bool BuildMaps();
+	/** Get the decoded instructions of iSize bytes of code at pData, NULL if not decoded */
+	const DecodedInsn *FindDecoded(u32 dwAddr, u32 iSize, const u8 *pData) const;
 	void BuildSymbols(SymbolMap &syms, u32 dwBase);
 	void FreeSymbols(SymbolMap &syms);
-	void FreeImms(ImmMap &imms);
 	void FixupRelocs(u32 dwBase, ImmMap &imms);
+	void CountLoadStats();
+	const char *GetNidName(const char *lib, u32 nid);
 	bool ReadString(u32 dwAddr, std::string &str, bool unicode, u32 *dwRet);
-	void DumpStrings(FILE *fp, u32 dwAddr, u32 iSize, unsigned char *pData);
-	void PrintRow(FILE *fp, const u32* row, s32 row_size, u32 addr);
-	void DumpData(FILE *fp, u32 dwAddr, u32 iSize, unsigned char *pData);
-	void Disasm(FILE *fp, u32 dwAddr, u32 iSize, unsigned char *pData, ImmMap &imms, u32 dwBase);
-	void DisasmXML(FILE *fp, u32 dwAddr, u32 iSize, unsigned char *pData, ImmMap &imms, u32 dwBase);
+	void PutString(COutputSink &out, const u8 *pData, u32 iLen, u32 iStep);
+	void DumpStrings(COutputSink &out, u32 dwAddr, u32 iSize, unsigned char *pData);
+	void PrintRow(COutputSink &out, const u32* row, s32 row_size, u32 addr);
+	void DumpData(COutputSink &out, u32 dwAddr, u32 iSize, unsigned char *pData);
+	void Disasm(COutputSink &out, u32 dwAddr, u32 iSize, unsigned char *pData, ImmMap &imms, u32 dwBase, DisasmContext *ctx);
+	void DisasmXML(COutputSink &out, u32 dwAddr, u32 iSize, unsigned char *pData, ImmMap &imms, u32 dwBase, DisasmContext *ctx);
+	void DisasmSection(COutputSink &out, u32 dwAddr, u32 iSize, unsigned char *pData, bool blXml);
+	static void DisasmChunkWork(int iIndex, void *pArg);
+	static void DisasmChunkDone(int iIndex, void *pArg);
 	void CalcElfSize(size_t &iTotal, size_t &iSectCount, size_t &iStrSize);
 	bool OutputElfHeader(FILE *fp, size_t iSectCount);
 	bool OutputSections(FILE *fp, size_t iElfHeadSize, size_t iSectCount, size_t iStrSize);
@@ -68,6 +94,8 @@ public:
 	bool PrxToElf(FILE *fp);
 
 	void SetXmlDump();
+	/** Set the number of threads used to disassemble, 0 uses every CPU */
+	void SetThreads(int iThreads);
 	PspModule* GetModuleInfo();
 	ElfReloc* GetRelocs(int &iCount);
 	ElfSymbol* GetSymbols(int &iCount);
@@ -77,6 +105,11 @@ public:
 	void Dump(FILE *fp, const char *disopts);
 	void DumpXML(FILE *fp, const char *disopts);
 	SymbolEntry *GetSymbolEntryFromAddr(u32 dwAddr);
+	/** Get the function symbols in address order */
+	void GetFunctions(std::vector<SymbolEntry *> &funcs);
+	/** Disassemble part of the code to out as Dump would, with its own options so it
+	 * can be called on several threads at once. Returns false if the range is not loaded */
+	bool DisasmRange(COutputSink &out, u32 dwAddr, u32 iSize, const char *disopts);
 };
 
 #endif
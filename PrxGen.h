@@ -0,0 +1,95 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * PrxGen.h - Definition of a class to generate synthetic PRX
+ * files for benchmarking.
+ ***************************************************************/
+
+#ifndef __PRXGEN_H__
+#define __PRXGEN_H__
+
+#include <vector>
+#include "types.h"
+
+/** What to put in a generated PRX */
+struct PrxGenOptions
+{
+	/** Seed for the random contents, the same options always give the same file */
+	u32 iSeed;
+	/** Bytes of code, not counting the import stubs */
+	u32 iTextSize;
+	/** Number of data sections */
+	int iDataSections;
+	/** Rough number of relocations, 0 for one for every 8 bytes of code */
+	int iRelocs;
+	/** Encode the relocations as a PT_PRXRELOC2 program header with no sections,
+	 * rather than SHT_PRXRELOC sections */
+	bool blTypeB;
+	int iImportLibs;
+	/** Number of functions imported from each library */
+	int iImportFuncs;
+	int iExportFuncs;
+};
+
+/** A relocation of the generated module before it is encoded */
+struct GenReloc
+{
+	/** Segment holding the relocated word and its offset in that segment */
+	u32 iOfsSeg;
+	u32 dwOffset;
+	u32 iType;
+	/** Segment the relocated value is relative to */
+	u32 iValSeg;
+	/** Low 16 bits of the value for a HI16 */
+	u32 dwAddend;
+};
+
+class CPrxGen
+{
+	PrxGenOptions m_opts;
+	u32 m_dwRand;
+	/* The two loaded segments, text and read only data then data */
+	std::vector<u8> m_seg0;
+	std::vector<u8> m_seg1;
+	std::vector<GenReloc> m_relocs;
+	std::vector<u32> m_funcs;
+	std::vector<u32> m_strings;
+	/* Section layout of the first segment */
+	u32 m_dwStubs;
+	u32 m_dwLibEnt;
+	u32 m_dwLibStub;
+	u32 m_dwModInfo;
+	u32 m_dwResident;
+	u32 m_dwNids;
+	u32 m_dwStrings;
+	u32 m_dwDataAddr;
+	std::vector<u32> m_dataSects;
+	u32 m_iBssSize;
+
+	u32 Rand();
+	u32 RandRange(u32 iRange);
+	static void Put32(std::vector<u8> &data, u32 dwOfs, u32 dwVal);
+	static void Add32(std::vector<u8> &data, u32 dwVal);
+	static u32 AddString(std::vector<u8> &data, const char *str);
+	void AddReloc(u32 iOfsSeg, u32 dwOffset, u32 iType, u32 iValSeg, u32 dwAddend);
+	void BuildText(u32 iWords, u32 iStubs, int iBudget);
+	void Build();
+	void EncodeTypeA(std::vector<u8> &out, u32 iSeg);
+	void EncodeTypeB(std::vector<u8> &out);
+public:
+	CPrxGen(const PrxGenOptions &opts);
+	~CPrxGen();
+	/** Fill in the options for a module of a typical size */
+	static void DefaultOptions(PrxGenOptions &opts);
+	/** Get the name of an imported function, names are the same in every module */
+	static void GetImportName(char *szName, int iSize, int iLib, int iFunc);
+	static void GetLibName(char *szName, int iSize, int iLib);
+	/** Write the module as an ELF file */
+	bool WritePrx(const char *szFilename);
+	/** Write a NID XML file naming three out of four of the imports */
+	bool WriteXml(const char *szFilename);
+	int GetRelocCount() const { return m_relocs.size(); }
+};
+
+#endif
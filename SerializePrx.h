@@ -63,6 +63,8 @@ public:
 	bool Begin();
 	bool SerializePrx(CProcessPrx &prx, u32 iSMask);
 	bool End();
+	/** Get the number of bytes output so far */
+	virtual unsigned long long GetOutputSize()							= 0;
 };
 
 #endif
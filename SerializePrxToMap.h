@@ -11,10 +11,11 @@
 
 #include <stdio.h>
 #include "SerializePrx.h"
+#include "OutputSink.h"
 
 class CSerializePrxToMap : public CSerializePrx
 {
-	FILE *m_fpOut;
+	COutputSink m_out;
 
 	virtual bool StartFile();
 	virtual bool EndFile();
@@ -36,6 +37,7 @@ class CSerializePrxToMap : public CSerializePrx
 public:
 	CSerializePrxToMap(FILE *fpOut);
 	~CSerializePrxToMap();
+	virtual unsigned long long GetOutputSize();
 };
 
 #endif
@@ -11,10 +11,11 @@
 
 #include <stdio.h>
 #include "SerializePrx.h"
+#include "OutputSink.h"
 
 class CSerializePrxToXml : public CSerializePrx
 {
-	FILE *m_fpOut;
+	COutputSink m_out;
 
 	virtual bool StartFile();
 	virtual bool EndFile();
@@ -36,6 +37,7 @@ class CSerializePrxToXml : public CSerializePrx
 public:
 	CSerializePrxToXml(FILE *fpOut);
 	~CSerializePrxToXml();
+	virtual unsigned long long GetOutputSize();
 };
 
 #endif
@@ -0,0 +1,92 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * Server.h - Definition of a class to answer queries about
+ * modules kept loaded, over a Unix socket.
+ ***************************************************************/
+
+#ifndef __SERVER_H__
+#define __SERVER_H__
+
+#include <pthread.h>
+#include <sys/types.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "ProcessPrx.h"
+#include "OutputSink.h"
+
+/** Default number of modules kept loaded */
+#define SERVER_DEFAULT_MODULES 16
+
+/** A loaded module, shared between the connections using it */
+struct ServerModule
+{
+	std::string file;
+	CProcessPrx *pPrx;
+	/** Functions in address order, to find the one containing an address */
+	std::vector<SymbolEntry *> funcs;
+	/** Modification time and size of the file when it was loaded */
+	time_t mtime;
+	off_t size;
+	/** Number of requests using the module, it is only freed when this is 0 */
+	int iRefs;
+	/** Set when the module has been dropped from the cache */
+	bool blEvicted;
+	unsigned long long iLastUse;
+};
+
+/** A value of a request, requests are flat JSON objects */
+struct ServerValue
+{
+	bool blString;
+	std::string str;
+	double num;
+};
+
+typedef std::map<std::string, ServerValue> ServerRequest;
+
+class CPrxServer
+{
+	CNidMgr *m_pNids;
+	u32 m_dwBase;
+	unsigned int m_iMaxModules;
+	int m_iSocket;
+	volatile bool m_blStop;
+	/** Loaded modules keyed on file name, guarded by m_lock */
+	std::map<std::string, ServerModule *> m_modules;
+	/** Open connections, so a shutdown can stop them waiting */
+	std::set<int> m_clients;
+	unsigned long long m_iUseCount;
+	pthread_mutex_t m_lock;
+
+	static void *ThreadEntry(void *pArg);
+	void AcceptLoop();
+	void HandleConnection(int fd);
+	void HandleRequest(const char *szLine, COutputSink &out);
+	static bool ParseRequest(const char *szLine, ServerRequest &req);
+	static void PutString(COutputSink &out, const char *str);
+	ServerModule *Acquire(const std::string &file, bool &blCached, std::string &error);
+	void Release(ServerModule *pMod);
+	void Unload(const std::string &file);
+	void Evict();
+	static void FreeModule(ServerModule *pMod);
+	static SymbolEntry *FindFunction(ServerModule *pMod, u32 dwAddr);
+	void OutputModules(COutputSink &out);
+	static void OutputEntries(COutputSink &out, const PspEntry *pEntries, int iCount);
+	static void OutputImports(COutputSink &out, CProcessPrx &prx);
+	static void OutputExports(COutputSink &out, CProcessPrx &prx);
+	static void OutputInfo(COutputSink &out, CProcessPrx &prx);
+	static bool OutputSymbol(COutputSink &out, ServerModule *pMod, u32 dwAddr);
+	static bool OutputDisasm(COutputSink &out, ServerModule *pMod, const ServerRequest &req, std::string &error);
+public:
+	CPrxServer(CNidMgr *pNids, u32 dwBase, unsigned int iMaxModules);
+	~CPrxServer();
+	/** Listen on szPath and answer requests on iThreads threads (0 uses every CPU)
+	 * until a shutdown request, returns false if the socket could not be set up */
+	bool Run(const char *szPath, int iThreads);
+};
+
+#endif
@@ -0,0 +1,75 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * Stats.h - Definition of a class to collect the timings and
+ * counters of processing each file.
+ ***************************************************************/
+
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <stdio.h>
+#include <vector>
+#include <string>
+
+/** The phases of processing a file, in the order they run */
+enum StatPhase
+{
+	PHASE_READ = 0,
+	PHASE_SECTIONS,
+	PHASE_RELOCS,
+	PHASE_FIXUP,
+	PHASE_EXPORTS,
+	PHASE_IMPORTS,
+	PHASE_FAKE_SECTIONS,
+	PHASE_MAPS,
+	PHASE_OUTPUT,
+	PHASE_COUNT,
+};
+
+enum StatCounter
+{
+	COUNT_BYTES_READ = 0,
+	COUNT_RELOCS,
+	COUNT_IMMS,
+	COUNT_SYMBOLS,
+	COUNT_NID_HITS,
+	COUNT_NID_MISSES,
+	COUNT_INSTRUCTIONS,
+	COUNT_BYTES_WRITTEN,
+	COUNT_MAX,
+};
+
+/** Wall time in seconds of each phase and the counters of a single file */
+struct FileStats
+{
+	double phases[PHASE_COUNT];
+	unsigned long long counters[COUNT_MAX];
+	bool blLoaded;
+};
+
+class CStats
+{
+	std::vector<std::string> m_names;
+	std::vector<FileStats> m_files;
+
+	static void Sum(FileStats &total, const FileStats &stats);
+	static void PrintFile(const char *szName, const FileStats &stats);
+	static void WriteJsonFile(FILE *fp, const FileStats &stats, const char *szIndent);
+public:
+	/** Get a monotonic time in seconds */
+	static double GetTime();
+	static void Clear(FileStats &stats);
+	/** Add the time since dStart to a phase and return the current time, so the next
+	 * phase can start from it. Does nothing but return dStart if pStats is NULL */
+	static double AddPhase(FileStats *pStats, StatPhase phase, double dStart);
+	/** Add the stats of a file, files are reported in the order they are added */
+	void Add(const char *szName, const FileStats &stats);
+	/** Print the stats of each file and the totals */
+	void Print();
+	/** Write the stats as a JSON object */
+	bool WriteJson(FILE *fp);
+};
+
+#endif
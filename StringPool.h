@@ -0,0 +1,41 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * StringPool.h - Definition of a class to intern strings.
+ ***************************************************************/
+
+#ifndef __STRINGPOOL_H__
+#define __STRINGPOOL_H__
+
+#include <vector>
+
+/* FNV-1a offset basis and prime, shared by the string hashes */
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME        16777619U
+
+/* Holds one copy of each string added, the copies stay valid until Clear is called */
+class CStringPool
+{
+	/* Blocks of string data, only the last one is filled */
+	std::vector<char *> m_blocks;
+	/* Bytes used in the last block */
+	unsigned int m_iBlockUsed;
+	/* Open addressing hash of the pooled strings, size is a power of 2 */
+	std::vector<const char *> m_table;
+	unsigned int m_iCount;
+
+	char *AllocString(unsigned int iSize);
+	void Grow();
+public:
+	CStringPool();
+	~CStringPool();
+	/** FNV-1a hash of a string */
+	static unsigned int HashString(const char *str);
+	/** Get the pooled copy of a string, adding it if not already present */
+	const char *Add(const char *str);
+	/** Free all pooled strings */
+	void Clear();
+};
+
+#endif
@@ -0,0 +1,29 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * WorkerPool.h - Definition of a class to process a batch of
+ * items on several threads while consuming them in order.
+ ***************************************************************/
+
+#ifndef __WORKERPOOL_H__
+#define __WORKERPOOL_H__
+
+/** Callback for a single item of a batch, iIndex is its position in the batch */
+typedef void (*WorkerFunc)(int iIndex, void *pArg);
+
+class CWorkerPool
+{
+	/** Number of threads to run the work callback on */
+	int m_iThreads;
+public:
+	CWorkerPool(int iThreads);
+	~CWorkerPool();
+	/** Call fnWork for each item on the worker threads and fnDone for each
+	 * item on the calling thread, strictly in index order */
+	void Run(int iCount, WorkerFunc fnWork, WorkerFunc fnDone, void *pArg);
+	/** Get the number of online CPUs */
+	static int GetCpuCount();
+};
+
+#endif
@@ -7,10 +7,12 @@
 #ifndef __DISASM_H__
 #define __DISASM_H__
 
+#include <stdio.h>
 #include <map>
 #include <string>
 #include <vector>
 #include "prxtypes.h"
+#include "AddrMap.h"
 
 enum SymbolType
 {
@@ -36,17 +38,7 @@ struct SymbolEntry
 	std::vector<PspLibImport *> imported;
 };
 
-typedef std::map<unsigned int, SymbolEntry*> SymbolMap;
-
-struct ImmEntry
-{
-	unsigned int addr;
-	unsigned int target;
-	/* Does this entry point to a text section ? */
-	int text;
-};
-
-typedef std::map<unsigned int, ImmEntry *> ImmMap;
+typedef CAddrMap<SymbolEntry*> SymbolMap;
 
 #define DISASM_OPT_MAX       8
 #define DISASM_OPT_HEXINTS   'x'
@@ -63,6 +55,107 @@ typedef std::map<unsigned int, ImmEntry *> ImmMap;
 #define INSTR_TYPE_JUMP   4
 #define INSTR_TYPE_JAL    8
 
+/* Most operands of a decoded instruction */
+#define DISASM_MAX_OPERANDS 4
+
+/* Types of the operands of a decoded instruction */
+enum DisasmOperandType
+{
+	/* value is a CPU register */
+	DISASM_OPERAND_GPR = 1,
+	/* value is an FPU register */
+	DISASM_OPERAND_FPR,
+	/* value is a VFPU register, vtype is the register type (s, p, t, q, m, n or o) */
+	DISASM_OPERAND_VFPR,
+	/* value is a cop0, cop1, cop2, debug or numbered coprocessor register */
+	DISASM_OPERAND_COPREG,
+	/* value is an immediate, VFPU constants and conditions included */
+	DISASM_OPERAND_IMM,
+	/* value is an offset from the CPU register base */
+	DISASM_OPERAND_MEM,
+	/* value is the address a branch or jump goes to */
+	DISASM_OPERAND_TARGET,
+	/* value is the opcode, a VFPU prefix or rotator */
+	DISASM_OPERAND_VFPUCTRL,
+};
+
+struct DisasmOperand
+{
+	unsigned char type;
+	unsigned char vtype;
+	unsigned char base;
+	int value;
+};
+
+/* Flags of a decoded instruction */
+#define DISASM_INSN_UNKNOWN 1
+#define DISASM_INSN_LOAD    2
+#define DISASM_INSN_STORE   4
+/* A jump to the address in a register */
+#define DISASM_INSN_JUMPREG 8
+
+/* An instruction decoded once, to be analysed or rendered without decoding it again */
+struct DecodedInsn
+{
+	unsigned int opcode;
+	unsigned int PC;
+	/* Mnemonic ids of the instruction and of its macro, the same if it has no macro, see disasmGetName */
+	short id;
+	short macroid;
+	unsigned char flags;
+	unsigned char opcount;
+	/* INSTR_TYPE_* of a branch or jump with a known target, 0 for anything else */
+	int branchtype;
+	unsigned int target;
+	/* Masks of the CPU registers read and written */
+	unsigned int regsread;
+	unsigned int regswritten;
+	/* Operands in the order they are printed */
+	DisasmOperand ops[DISASM_MAX_OPERANDS];
+};
+
+/* State of a disassembler, separate contexts can be used on separate threads */
+struct DisasmContext
+{
+	/* Options, see DISASM_OPT_* */
+	int hexints;
+	int mregs;
+	int symaddr;
+	int macroon;
+	int printreal;
+	int printregs;
+	int printswap;
+	int signedhex;
+	int xmloutput;
+	/* Mask of the registers printed by the last instruction */
+	int regmask;
+	/* Symbols to resolve addresses against, may be NULL */
+	SymbolMap *syms;
+	/* Text of the last disassembled instruction */
+	char code[1024];
+};
+
+/* Reset a context to the default options with no symbols */
+void disasmInitContext(DisasmContext *ctx);
+void disasmSetHexInts(DisasmContext *ctx, int hexints);
+void disasmSetMRegs(DisasmContext *ctx, int mregs);
+void disasmSetSymAddr(DisasmContext *ctx, int symaddr);
+void disasmSetMacro(DisasmContext *ctx, int macro);
+void disasmSetPrintReal(DisasmContext *ctx, int printreal);
+void disasmSetOpts(DisasmContext *ctx, const char *opts, int set);
+void disasmPrintOpts(DisasmContext *ctx);
+/* Returns a pointer to the context's buffer, valid until the next call with the same context */
+const char *disasmInstruction(DisasmContext *ctx, unsigned int opcode, unsigned int PC, unsigned int *realregs, unsigned int *regmask, int noaddr);
+const char *disasmInstructionXML(DisasmContext *ctx, unsigned int opcode, unsigned int PC);
+/* Render a decoded instruction the same as disasmInstruction */
+const char *disasmFormatInsn(DisasmContext *ctx, const DecodedInsn *insn, unsigned int *realregs, unsigned int *regmask, int noaddr);
+void disasmSetSymbols(DisasmContext *ctx, SymbolMap *syms);
+SymbolType disasmResolveSymbol(DisasmContext *ctx, unsigned int PC, char *name, int namelen);
+SymbolEntry* disasmFindSymbol(DisasmContext *ctx, unsigned int PC);
+void disasmSetXmlOutput(DisasmContext *ctx);
+
+/* The functions below work on a single shared context */
+
 /* Enable hexadecimal integers for immediates */
 void disasmSetHexInts(int hexints);
 /* Enable mnemonic MIPS registers */
@@ -79,10 +172,23 @@ const char *disasmInstruction(unsigned int opcode, unsigned int PC, unsigned int
 const char *disasmInstructionXML(unsigned int opcode, unsigned int PC);
 
 void disasmSetSymbols(SymbolMap *syms);
-void disasmAddBranchSymbols(unsigned int opcode, unsigned int PC, SymbolMap &syms);
 SymbolType disasmResolveSymbol(unsigned int PC, char *name, int namelen);
 SymbolEntry* disasmFindSymbol(unsigned int PC);
-int disasmIsBranch(unsigned int opcode, unsigned int PC, unsigned int *dwTarget);
 void disasmSetXmlOutput();
 
+/* The functions below don't use a context */
+
+void disasmAddBranchSymbols(unsigned int opcode, unsigned int PC, SymbolMap &syms);
+void disasmAddBranchSymbols(const DecodedInsn *insns, unsigned int count, SymbolMap &syms);
+/* Decode count instructions in memory order starting at address pc */
+void disasmDecodeBlock(const unsigned int *words, unsigned int count, unsigned int pc, DecodedInsn *out);
+/* Name of a mnemonic id of a decoded instruction, NULL for an unknown one */
+const char *disasmGetName(int id);
+int disasmIsBranch(unsigned int opcode, unsigned int PC, unsigned int *dwTarget);
+/* Samples value to check every opcode */
+#define DISASM_CHECK_ALL 0xFFFFFFFF
+/* Cross check the decode tables against a linear scan of the instruction tables and the
+ * compiled formats against the format strings, returns the error count */
+int disasmSelfCheck(FILE *fp, unsigned int iSamples);
+
 #endif
@@ -0,0 +1,104 @@
+/***************************************************************
+ * PRXTool : Utility for PSP executables.
+ * (c) TyRaNiD 2k5
+ *
+ * nidtypes.h - Definition of the binary NID database format.
+ ***************************************************************/
+
+#ifndef __NIDTYPES_H__
+#define __NIDTYPES_H__
+
+#include "types.h"
+
+/* All values are stored little endian, all sections are 4 byte aligned */
+#define NIDDB_MAGIC   "PNDB"
+#define NIDDB_VERSION 1
+
+/* Value used for an unset index or string offset */
+#define NIDDB_NONE    0xFFFFFFFF
+
+enum NidDbSectionType
+{
+	/* NUL terminated strings, referenced by byte offset */
+	NIDDB_SECT_STRINGS = 1,
+	/* Array of NidDbLib in library list order */
+	NIDDB_SECT_LIBS = 2,
+	/* Array of NidDbNid, each library owns a contiguous run */
+	NIDDB_SECT_NIDS = 3,
+	/* Hash table of NidDbHashEntry keyed on library name and NID */
+	NIDDB_SECT_LIBINDEX = 4,
+	/* Hash table of NidDbHashEntry keyed on NID for the master NID table */
+	NIDDB_SECT_MASTERINDEX = 5,
+};
+
+struct NidDbHeader
+{
+	char magic[4];
+	u32 version;
+	/* Number of NidDbSection entries following the header */
+	u32 sectcount;
+	/* Index of the master NID library or NIDDB_NONE */
+	u32 master;
+};
+
+struct NidDbSection
+{
+	u32 type;
+	u32 offset;
+	u32 size;
+};
+
+struct NidDbLib
+{
+	u32 prx_name;
+	u32 lib_name;
+	u32 prx;
+	u32 flags;
+	/* Index of the first NID in the NIDS section */
+	u32 nids;
+	u32 entry_count;
+	u32 vcount;
+	u32 fcount;
+};
+
+struct NidDbNid
+{
+	u32 nid;
+	u32 name;
+};
+
+/* Slot of an open addressing hash table, the table size is a power of 2 */
+struct NidDbHashEntry
+{
+	u32 hash;
+	u32 nid;
+	/* Library name, NIDDB_NONE in the master table */
+	u32 lib;
+	/* Symbol name, NIDDB_NONE for an empty slot */
+	u32 name;
+};
+
+/* Cached copy of a functions file, a header followed by an array of FuncDbEntry
+ * then the NUL terminated strings they reference */
+#define FUNCDB_MAGIC   "PFDB"
+#define FUNCDB_VERSION 2
+
+struct FuncDbHeader
+{
+	char magic[4];
+	u32 version;
+	/* Number of entries following the header */
+	u32 count;
+	/* Size of the strings following the entries */
+	u32 strsize;
+};
+
+/* Byte offsets of the strings of a prototype */
+struct FuncDbEntry
+{
+	u32 name;
+	u32 args;
+	u32 ret;
+};
+
+#endif
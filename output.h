@@ -8,6 +8,9 @@
 #ifndef __OUTPUT_H__
 #define __OUTPUT_H__
 
+#include <string>
+#include <vector>
+
 enum OutputLevel
 {
 	LEVEL_INFO = 0,
@@ -18,17 +21,30 @@ enum OutputLevel
 
 typedef void (*OutputHandler)(OutputLevel level, const char *szDebug);
 
+/** A single message held back in an output buffer */
+struct OutputMessage
+{
+	OutputLevel level;
+	std::string text;
+};
+
+typedef std::vector<OutputMessage> OutputBuffer;
+
 class COutput
 {
 	/* Enables debug output */
 	static bool m_blDebug;
 	static OutputHandler m_fnOutput;
+	/* Buffer collecting the output of the current thread, NULL to output directly */
+	static thread_local OutputBuffer *m_pBuffer;
 	COutput() {};
 	~COutput() {};
 public:
 	static void SetDebug(bool blDebug);
 	static bool GetDebug();
 	static void SetOutputHandler(OutputHandler fn);
+	static void SetBuffer(OutputBuffer *pBuffer);
+	static void Flush(OutputBuffer &buffer);
 	static void Puts(OutputLevel level, const char *str);
 	static void Printf(OutputLevel level, const char *str, ...);
 };
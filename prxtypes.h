@@ -12,11 +12,6 @@
 #include "types.h"
 
 #define PSP_MODULE_MAX_NAME 28
-#define PSP_LIB_MAX_NAME 128
-#define PSP_ENTRY_MAX_NAME 128
-/* Define the maximum number of permitted entries per lib */
-#define PSP_MAX_V_ENTRIES 255
-#define PSP_MAX_F_ENTRIES 2000
 
 #define PSP_MODULE_INFO_NAME ".rodata.sceModuleInfo"
 
@@ -69,8 +64,8 @@ struct PspModuleInfo
 /* Define the loaded prx types */
 struct PspEntry
 {
-	/* Name of the entry */
-	char name[PSP_ENTRY_MAX_NAME];
+	/* Name of the entry, owned by the module's string pool */
+	const char *name;
 	/* Nid of the entry */
 	u32 nid;
 	/* Type of the entry */
@@ -89,21 +84,21 @@ struct PspLibImport
 	/** Next import */
 	PspLibImport *next;
 	/** Name of the library */
-	char name[PSP_LIB_MAX_NAME];
+	const char *name;
 	/** Virtual address of the lib import stub */
 	u32 addr;
 	/** Copy of the import stub (in native byte order) */
 	PspModuleImport stub;
-	/** List of function entries */
-	PspEntry funcs[PSP_MAX_F_ENTRIES];
+	/** Array of f_count function entries */
+	PspEntry *funcs;
 	/** Number of function entries */
 	int f_count;
-	/** List of variable entried */
-	PspEntry vars[PSP_MAX_V_ENTRIES];
+	/** Array of v_count variable entries */
+	PspEntry *vars;
 	/** Number of variable entries */
 	int v_count;
-	/** File containing the export */
-	char file[PATH_MAX];
+	/** File containing the export, empty if not known */
+	const char *file;
 };
 
 /* Holds a linking entry for an export library */
@@ -114,17 +109,17 @@ struct PspLibExport
 	/** Next export in the chain */
 	PspLibExport *next;
 	/** Name of the library */
-	char name[PSP_LIB_MAX_NAME];
+	const char *name;
 	/** Virtual address of the lib import stub */
 	u32 addr;
 	/** Copy of the import stub (in native byte order) */
 	PspModuleExport stub;
-	/** List of function entries */
-	PspEntry funcs[PSP_MAX_F_ENTRIES];
+	/** Array of f_count function entries */
+	PspEntry *funcs;
 	/** Number of function entries */
 	int f_count;
-	/** List of variable entried */
-	PspEntry vars[PSP_MAX_V_ENTRIES];
+	/** Array of v_count variable entries */
+	PspEntry *vars;
 	/** Number of variable entires */
 	int v_count;
 };